@@ -0,0 +1,113 @@
+#ifndef DENSITYINDEX_H
+#define DENSITYINDEX_H
+
+#include <vector>
+#include <algorithm>
+
+// Índice de dificultad compartido por el motor Qt (DyslexiaLogic) y el
+// visor de consola (pruebaKMPAplicacion.cpp). No depende de Qt.
+
+// Rango de texto [start, start + length)
+struct TextRange {
+    int start;
+    int length;
+};
+
+// Categorías que se cuentan para medir la dificultad de un tramo
+enum DifficultyCategory {
+    LetterCategory = 0,    // Letra confundible suelta (b, d, m, n...)
+    ClusterCategory = 1,   // Sílaba trabada o arco de varias letras (bra, mn...)
+    ConfusionCategory = 2, // Dos letras confundibles muy juntas (ver ConfusionGap)
+    CategoryCount = 3
+};
+
+// Índice de sumas prefijas sobre las coincidencias de cada categoría.
+// prefix[c][i] = coincidencias de la categoría c que empiezan antes de i,
+// así que cualquier rango [start, end) se puntúa en O(1).
+//
+// Convención de posición: una coincidencia cuenta donde EMPIEZA, y una zona
+// de confusión cuenta en su PRIMERA letra.
+//
+// Uso: reset(n) -> addMatch(...) por cada coincidencia -> finish().
+struct DensityIndex {
+    // Dos letras confundibles forman zona si distan menos de esto
+    static constexpr int ConfusionGap = 5;
+    // Peso de cada categoría en score(): sílabas y zonas cuestan más que una letra
+    static constexpr int Weights[CategoryCount] = {1, 2, 3};
+
+    std::vector<int> prefix[CategoryCount];
+
+    static bool isConfusionPair(int first, int second) { return second - first < ConfusionGap; }
+
+    // Deja el índice a cero para un texto de len caracteres (reutiliza la capacidad)
+    void reset(int len) {
+        for (auto &p : prefix) p.assign(len + 1, 0);
+    }
+
+    void addMatch(int category, int pos) { prefix[category][pos + 1]++; }
+
+    // Añade una zona por cada par de letras (LetterCategory) consecutivas
+    // que cumplan isConfusionPair. Se llama antes de finish().
+    void addConfusionZones() {
+        int lastLetter = -1;
+        for (int i = 0; i < length(); i++) {
+            if (prefix[LetterCategory][i + 1] == 0) continue;
+            if (lastLetter >= 0 && isConfusionPair(lastLetter, i)) addMatch(ConfusionCategory, lastLetter);
+            lastLetter = i;
+        }
+    }
+
+    // Convierte los conteos por posición en sumas prefijas
+    void finish() {
+        for (auto &p : prefix)
+            for (int i = 0; i + 1 < static_cast<int>(p.size()); i++) p[i + 1] += p[i];
+    }
+
+    int length() const {
+        return prefix[0].empty() ? 0 : static_cast<int>(prefix[0].size()) - 1;
+    }
+
+    // Coincidencias de una categoría en [start, end); el rango se recorta al texto
+    int count(int category, int start, int end) const {
+        start = std::max(start, 0);
+        end = std::min(end, length());
+        if (category < 0 || category >= CategoryCount || start >= end) return 0;
+        return prefix[category][end] - prefix[category][start];
+    }
+
+    // Puntos ponderados por cada 100 caracteres del rango (0 si está vacío)
+    double score(int start, int end) const {
+        start = std::max(start, 0);
+        end = std::min(end, length());
+        if (start >= end) return 0.0;
+
+        int points = 0;
+        for (int c = 0; c < CategoryCount; c++) points += Weights[c] * count(c, start, end);
+        return 100.0 * points / (end - start);
+    }
+
+    // Mapa de calor: puntuación de cada bloque de bucketSize caracteres
+    void heatmap(int bucketSize, std::vector<double> &out) const {
+        out.clear();
+        if (bucketSize <= 0) return;
+        for (int start = 0; start < length(); start += bucketSize)
+            out.push_back(score(start, start + bucketSize));
+    }
+
+    // Ventana de windowSize caracteres con mayor puntuación (O(n), la primera si empatan)
+    TextRange hardestWindow(int windowSize) const {
+        int len = length();
+        if (windowSize <= 0 || len == 0) return {0, 0};
+        if (windowSize >= len) return {0, len};
+
+        int bestStart = 0;
+        double bestScore = -1.0;
+        for (int start = 0; start + windowSize <= len; start++) {
+            double s = score(start, start + windowSize);
+            if (s > bestScore) { bestScore = s; bestStart = start; }
+        }
+        return {bestStart, windowSize};
+    }
+};
+
+#endif // DENSITYINDEX_H
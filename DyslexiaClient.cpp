@@ -0,0 +1,145 @@
+#include "DyslexiaClient.h"
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <cstring>
+
+using namespace DyslexiaProtocol;
+
+// Tamaño mínimo del segmento compartido (en bytes)
+static const qsizetype MinSegmentSize = 64 * 1024;
+
+DyslexiaClient::DyslexiaClient() {}
+
+DyslexiaClient::~DyslexiaClient() {
+    disconnectFromServer();
+}
+
+bool DyslexiaClient::connectToServer(const QString &name, int timeoutMs) {
+    serverName = name;
+    buffer.clear();
+    socket.connectToServer(name);
+    if (!socket.waitForConnected(timeoutMs)) return fail(socket.errorString());
+    return true;
+}
+
+void DyslexiaClient::disconnectFromServer() {
+    serverName.clear();
+    if (socket.state() != QLocalSocket::UnconnectedState) {
+        socket.disconnectFromServer();
+        if (socket.state() != QLocalSocket::UnconnectedState) socket.waitForDisconnected(1000);
+    }
+    if (shm.isAttached()) shm.detach();
+}
+
+bool DyslexiaClient::isConnected() const {
+    return socket.state() == QLocalSocket::ConnectedState;
+}
+
+QString DyslexiaClient::errorString() const {
+    return lastError;
+}
+
+bool DyslexiaClient::fail(const QString &message) {
+    lastError = message;
+    return false;
+}
+
+// Corta la conexión para que ningún byte pendiente desalinee el flujo de
+// frames; la siguiente llamada a analyze() vuelve a conectar
+bool DyslexiaClient::dropConnection(const QString &message) {
+    socket.abort();
+    buffer.clear();
+    return fail(message);
+}
+
+// El segmento solo crece; cada crecimiento usa una clave nueva para que el
+// servidor sepa que debe volver a adjuntarlo
+bool DyslexiaClient::ensureSegment(qsizetype bytes) {
+    if (shm.isAttached() && shm.size() >= bytes) return true;
+
+    qsizetype size = qMax(bytes, MinSegmentSize);
+    if (shm.isAttached()) {
+        size = qMax(size, shm.size() * 2);
+        shm.detach();
+    }
+
+    shm.setKey(QStringLiteral("dyslexia-focus-%1-%2")
+                   .arg(QCoreApplication::applicationPid())
+                   .arg(segmentCount++));
+    if (!shm.create(size)) return fail(shm.errorString());
+    return true;
+}
+
+bool DyslexiaClient::analyze(const QString &text, int mode, std::vector<TextStyle> &out, int timeoutMs) {
+    out.clear();
+    if (!isConnected()) {
+        // Tras un plazo vencido se cortó la conexión: se reconecta aquí
+        if (serverName.isEmpty()) return fail(QStringLiteral("No hay conexión con el servidor"));
+        if (!connectToServer(serverName, timeoutMs)) return false;
+    }
+
+    QDeadlineTimer deadline(timeoutMs);
+    qsizetype len = text.size();
+
+    // 1. Copiar el texto a la memoria compartida
+    QByteArray key;
+    if (len > 0) {
+        if (!ensureSegment(len * qsizetype(sizeof(QChar)))) return false;
+        shm.lock();
+        std::memcpy(shm.data(), text.constData(), size_t(len) * sizeof(QChar));
+        shm.unlock();
+        key = shm.key().toLatin1();
+    }
+
+    // 2. Enviar la petición
+    quint32 requestId = nextRequestId++;
+    request.resize(0);
+    int at = beginFrame(request);
+    request.append(char(Analyze));
+    putU32(request, requestId);
+    putU32(request, quint32(mode));
+    putU32(request, quint32(len));
+    putU16(request, quint16(key.size()));
+    request.append(key);
+    endFrame(request, at);
+
+    socket.write(request);
+    if (socket.bytesToWrite() > 0 && !socket.waitForBytesWritten(int(deadline.remainingTime())))
+        return dropConnection(socket.errorString());
+
+    // 3. Esperar la respuesta a ESTA petición. Las respuestas atrasadas de
+    // peticiones anteriores (que vencieron su plazo) se descartan.
+    while (true) {
+        qsizetype frame = 0;
+        while ((frame = nextFrameSize(buffer)) == 0) {
+            if (!socket.waitForReadyRead(int(deadline.remainingTime())))
+                return dropConnection(socket.errorString());
+            buffer.append(socket.readAll());
+        }
+        if (frame < 0 || frame - FrameHeaderSize < ResponseFixedSize)
+            return dropConnection(QStringLiteral("Respuesta inválida del servidor"));
+
+        // 4. Decodificar la respuesta
+        const char *payload = buffer.constData() + FrameHeaderSize;
+        qsizetype size = frame - FrameHeaderSize;
+        quint8 status = quint8(payload[0]);
+        quint32 id = getU32(payload + 1);
+        quint32 count = getU32(payload + 5);
+        if (id != requestId) {
+            buffer.remove(0, frame);
+            continue;
+        }
+
+        bool ok = false;
+        if (status != Ok) {
+            lastError = QStringLiteral("El servidor rechazó la petición (estado %1)").arg(status);
+        } else if (size != ResponseFixedSize + qsizetype(count) * SpanSize) {
+            lastError = QStringLiteral("Respuesta inválida del servidor");
+        } else {
+            readSpans(payload + ResponseFixedSize, count, out);
+            ok = true;
+        }
+        buffer.remove(0, frame);
+        return ok;
+    }
+}
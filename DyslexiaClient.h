@@ -0,0 +1,45 @@
+#ifndef DYSLEXIACLIENT_H
+#define DYSLEXIACLIENT_H
+
+#include <QLocalSocket>
+#include <QSharedMemory>
+#include <QByteArray>
+#include <vector>
+#include "DyslexiaLogic.h"
+#include "DyslexiaProtocol.h"
+
+// Cliente síncrono del servidor local de análisis. Pensado para procesos
+// de vida corta (plugins, scripts de exportación) que no quieren cargar el
+// motor: el texto se pasa por memoria compartida y se reciben los tramos.
+class DyslexiaClient {
+public:
+    DyslexiaClient();
+    ~DyslexiaClient();
+
+    bool connectToServer(const QString &name = DyslexiaProtocol::defaultServerName(),
+                         int timeoutMs = 1000);
+    void disconnectFromServer();
+    bool isConnected() const;
+
+    // Mismo resultado que DyslexiaLogic::analyzeText, calculado por el servidor.
+    // Si vence el plazo se corta la conexión y la siguiente llamada reconecta.
+    bool analyze(const QString &text, int mode, std::vector<TextStyle> &out, int timeoutMs = 5000);
+
+    QString errorString() const;
+
+private:
+    QLocalSocket socket;
+    QSharedMemory shm;
+    QByteArray request;
+    QByteArray buffer;
+    quint32 nextRequestId = 1;
+    int segmentCount = 0;
+    QString lastError;
+    QString serverName; // Para reconectar tras un error
+
+    bool ensureSegment(qsizetype bytes);
+    bool fail(const QString &message);
+    bool dropConnection(const QString &message);
+};
+
+#endif // DYSLEXIACLIENT_H
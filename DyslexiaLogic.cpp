@@ -1,14 +1,9 @@
-#include "dyslexialogic.h"
+#include "DyslexiaLogic.h"
 #include <vector>
+#include <climits>
+#include <algorithm>
 #include <QStringList>
 
-// Estructura interna para el mapa de resolución de conflictos
-struct StyleMapInfo {
-    unsigned int color;
-    int priority;
-    bool active; // Si hay algo pintado aquí
-};
-
 // --- KMP Core (Intacto) ---
 std::vector<int> DyslexiaLogic::buildLPS(const QString &pattern) {
     int m = pattern.length();
@@ -26,13 +21,16 @@ std::vector<int> DyslexiaLogic::buildLPS(const QString &pattern) {
     return lps;
 }
 
-std::vector<int> DyslexiaLogic::KMPsearch(const QString &text, const QString &pattern) {
-    std::vector<int> matches;
-    QString lowerText = text.toLower(); // Normalización
-
-    std::vector<int> lps = buildLPS(pattern);
-    int n = text.length();
+// Búsqueda KMP sobre el texto ya normalizado; cada coincidencia se pinta
+// directamente en el mapa (sin vector intermedio de posiciones) y se cuenta
+// en el índice de dificultad
+void DyslexiaLogic::KMPsearch(const std::vector<QChar> &lowerText, const CompiledPattern &cp,
+                              std::vector<StyleMapInfo> &styleMap, DensityIndex &density, int category) {
+    const QString &pattern = cp.pattern;
+    const std::vector<int> &lps = cp.lps;
+    int n = static_cast<int>(lowerText.size());
     int m = pattern.length();
+    if (m == 0) return;
     int i = 0, j = 0;
 
     while (i < n) {
@@ -40,18 +38,24 @@ std::vector<int> DyslexiaLogic::KMPsearch(const QString &text, const QString &pa
             i++; j++;
         }
         if (j == m) {
-            matches.push_back(i - j);
+            density.addMatch(category, i - j);
+            for (int k = i - j; k < i; k++) {
+                if (!styleMap[k].active || cp.priority > styleMap[k].priority) {
+                    styleMap[k].color = cp.color;
+                    styleMap[k].priority = cp.priority;
+                    styleMap[k].active = true;
+                }
+            }
             j = lps[j - 1];
         } else if (i < n && lowerText[i] != pattern[j]) {
             if (j != 0) j = lps[j - 1];
             else i++;
         }
     }
-    return matches;
 }
 
-// --- Lógica con Resolución de Conflictos (Versión Completa) ---
-std::vector<TextStyle> DyslexiaLogic::analyzeText(const QString &text, int mode) {
+// --- Configuración de patrones por modo ---
+std::vector<DyslexiaLogic::PatternConfig> DyslexiaLogic::modeConfigs(int mode) {
     std::vector<PatternConfig> configs;
 
     // COLORES
@@ -73,7 +77,7 @@ std::vector<TextStyle> DyslexiaLogic::analyzeText(const QString &text, int mode)
             "bra", "bre", "bri", "bro", "bru", "bla", "ble", "bli", "blo", "blu",
             "dra", "dre", "dri", "dro", "dru", "pla", "ple", "pli", "plo", "plu",
             "cla", "cle", "cli", "clo", "clu",
-            "pra", "pre", "pri", "pro", "pru", "pla", "ple", "pli", "plo", "plu"
+            "pra", "pre", "pri", "pro", "pru"
         };
         for(const QString &s : trabadas) configs.push_back({s, cSyllable, 50});
     }
@@ -111,29 +115,71 @@ std::vector<TextStyle> DyslexiaLogic::analyzeText(const QString &text, int mode)
         for(const QString &s : verticalComplex) configs.push_back({s, cSyllable, 50});
     }
 
-    // --- ALGORITMO DE FUSIÓN (MAPEO) ---
-    int len = text.length();
-    // (Nota: Si te da error aquí, asegúrate de tener definidos StyleMapInfo arriba)
-    std::vector<StyleMapInfo> styleMap(len, {0, 0, false});
-
-    for (const auto &cfg : configs) {
-        std::vector<int> found = KMPsearch(text, cfg.pattern);
-        for (int startPos : found) {
-            int endPos = startPos + cfg.pattern.length();
-            for (int k = startPos; k < endPos; k++) {
-                if (k < len) {
-                    if (!styleMap[k].active || cfg.priority > styleMap[k].priority) {
-                        styleMap[k].color = cfg.color;
-                        styleMap[k].priority = cfg.priority;
-                        styleMap[k].active = true;
-                    }
+    return configs;
+}
+
+// Los perfiles se compilan (patrón + LPS) la primera vez que se usan y se
+// conservan durante toda la vida del proceso. Un patrón repetido se compila
+// una sola vez (si no, sus coincidencias se contarían dos veces en el índice
+// de dificultad). La copia repetida solo pintaba donde tenía más prioridad,
+// así que basta con quedarse con la de mayor prioridad en su posición.
+const std::vector<DyslexiaLogic::CompiledPattern> &DyslexiaLogic::modeProfile(int mode) {
+    static const std::vector<std::vector<CompiledPattern>> profiles = [] {
+        std::vector<std::vector<CompiledPattern>> all(4);
+        for (int m = 0; m < 4; m++) {
+            for (const PatternConfig &cfg : modeConfigs(m)) {
+                auto dup = std::find_if(all[m].begin(), all[m].end(),
+                                        [&cfg](const CompiledPattern &cp) { return cp.pattern == cfg.pattern; });
+                if (dup != all[m].end()) {
+                    if (cfg.priority <= dup->priority) continue;
+                    all[m].erase(dup);
                 }
+                all[m].push_back({cfg.pattern, buildLPS(cfg.pattern), cfg.color, cfg.priority});
             }
         }
+        return all;
+    }();
+    static const std::vector<CompiledPattern> empty;
+
+    if (mode < 0 || mode >= static_cast<int>(profiles.size())) return empty;
+    return profiles[mode];
+}
+
+// --- Lógica con Resolución de Conflictos (Versión Completa) ---
+std::vector<TextStyle> DyslexiaLogic::analyzeText(const QString &text, int mode) {
+    AnalysisContext ctx;
+    analyzeText(text, mode, ctx);
+    return std::move(ctx.results);
+}
+
+const std::vector<TextStyle> &DyslexiaLogic::analyzeText(const QString &text, int mode, AnalysisContext &ctx) {
+    int len = text.length();
+
+    // Los buffers solo crecen; si ya tienen capacidad no se reserva nada
+    if (ctx.lowerText.capacity() < static_cast<size_t>(len)) ctx.growths++;
+    if (ctx.styleMap.capacity() < static_cast<size_t>(len)) ctx.growths++;
+    ctx.lowerText.resize(len);
+    ctx.styleMap.assign(len, {0, 0, false});
+    ctx.results.clear();
+    for (auto &p : ctx.density.prefix)
+        if (p.capacity() < static_cast<size_t>(len) + 1) ctx.growths++;
+    ctx.density.reset(len);
+
+    // Normalización (una sola vez para todos los patrones)
+    for (int i = 0; i < len; i++) ctx.lowerText[i] = text[i].toLower();
+
+    // --- ALGORITMO DE FUSIÓN (MAPEO) ---
+    for (const auto &cp : modeProfile(mode)) {
+        int category = cp.pattern.length() == 1 ? LetterCategory : ClusterCategory;
+        KMPsearch(ctx.lowerText, cp, ctx.styleMap, ctx.density, category);
     }
+    ctx.density.addConfusionZones();
+    ctx.density.finish();
 
     // --- GENERAR RESULTADOS ---
-    std::vector<TextStyle> finalResults;
+    const std::vector<StyleMapInfo> &styleMap = ctx.styleMap;
+    std::vector<TextStyle> &finalResults = ctx.results;
+    size_t capacityBefore = finalResults.capacity();
     if (len == 0) return finalResults;
 
     int currentStart = -1;
@@ -157,5 +203,51 @@ std::vector<TextStyle> DyslexiaLogic::analyzeText(const QString &text, int mode)
     }
     if (tracking) finalResults.push_back({currentStart, len - currentStart, false, currentColor});
 
+    if (finalResults.capacity() != capacityBefore) ctx.growths++;
     return finalResults;
-}
\ No newline at end of file
+}
+
+// --- Diferencia entre dos aplicaciones de estilos ---
+std::vector<TextRange> DyslexiaLogic::diffStyles(const std::vector<TextStyle> &oldStyles,
+                                                 const std::vector<TextStyle> &newStyles) {
+    std::vector<TextRange> changes;
+    size_t i = 0, j = 0;
+    int pos = 0;
+
+    auto pushChange = [&changes](int start, int end) {
+        if (end <= start) return;
+        // Fusionar con el rango anterior si son contiguos
+        if (!changes.empty() && changes.back().start + changes.back().length == start)
+            changes.back().length += end - start;
+        else
+            changes.push_back({start, end - start});
+    };
+
+    // Barrido sobre las fronteras de ambas listas a la vez
+    while (i < oldStyles.size() || j < newStyles.size()) {
+        const TextStyle *a = nullptr;
+        const TextStyle *b = nullptr;
+        int next = INT_MAX;
+
+        if (i < oldStyles.size()) {
+            const TextStyle &s = oldStyles[i];
+            if (pos >= s.start) a = &s;
+            next = std::min(next, a ? s.start + s.length : s.start);
+        }
+        if (j < newStyles.size()) {
+            const TextStyle &s = newStyles[j];
+            if (pos >= s.start) b = &s;
+            next = std::min(next, b ? s.start + s.length : s.start);
+        }
+
+        if (a || b) {
+            bool same = a && b && a->colorHex == b->colorHex && a->isBackground == b->isBackground;
+            if (!same) pushChange(pos, next);
+        }
+        pos = next;
+
+        if (i < oldStyles.size() && pos >= oldStyles[i].start + oldStyles[i].length) i++;
+        if (j < newStyles.size() && pos >= newStyles[j].start + newStyles[j].length) j++;
+    }
+    return changes;
+}
@@ -3,6 +3,7 @@
 
 #include <QString> // Usamos QString para soportar tildes correctamente
 #include <vector>
+#include "DensityIndex.h"
 
 struct TextStyle {
     int start;
@@ -11,6 +12,32 @@ struct TextStyle {
     unsigned int colorHex;
 };
 
+// Estructura interna para el mapa de resolución de conflictos
+struct StyleMapInfo {
+    unsigned int color;
+    int priority;
+    bool active; // Si hay algo pintado aquí
+};
+
+// Memoria reutilizable entre análisis (la crea y conserva quien llama).
+// Los buffers se vacían pero no se liberan: tras el primer texto del
+// tamaño máximo, los análisis siguientes no piden memoria al sistema.
+struct AnalysisContext {
+    std::vector<QChar> lowerText;        // Texto normalizado a minúsculas
+    std::vector<StyleMapInfo> styleMap;  // Mapa de prioridades por carácter
+    std::vector<TextStyle> results;      // Salida del último análisis
+    DensityIndex density;                // Índice de dificultad del último análisis
+
+    // Veces que tuvo que crecer alguno de ESTOS buffers: lowerText, styleMap,
+    // results y density.prefix. No es un contador de reservas real; la
+    // prueba del motor (core_test.cpp) cuenta malloc en glibc (incluye las
+    // de Qt) y solo operator new en otras plataformas.
+    // Fuera de este contexto siguen reservando memoria: el analyzeText sin
+    // contexto (crea uno nuevo en cada llamada) y, en la GUI,
+    // QTextEdit::toPlainText() y la copia a appliedStyles.
+    size_t growths = 0;
+};
+
 class DyslexiaLogic {
 public:
     struct PatternConfig {
@@ -19,12 +46,34 @@ public:
         int priority;
     };
 
+    // Patrón con su tabla LPS ya calculada (se compila una sola vez por modo)
+    struct CompiledPattern {
+        QString pattern;
+        std::vector<int> lps;
+        unsigned int color;
+        int priority;
+    };
+
     // Recibe QString y devuelve posiciones exactas
     static std::vector<TextStyle> analyzeText(const QString &text, int mode);
 
+    // Igual que la anterior pero usando los buffers de ctx; el resultado
+    // vive en ctx.results hasta la siguiente llamada con el mismo contexto
+    static const std::vector<TextStyle> &analyzeText(const QString &text, int mode, AnalysisContext &ctx);
+
+    // Perfil compilado de un modo (vacío si el modo no existe)
+    static const std::vector<CompiledPattern> &modeProfile(int mode);
+
+    // Compara dos listas de estilos (ordenadas, sin solapes) y devuelve solo
+    // los rangos donde el color cambió. Coste: O(oldStyles + newStyles)
+    static std::vector<TextRange> diffStyles(const std::vector<TextStyle> &oldStyles,
+                                             const std::vector<TextStyle> &newStyles);
+
 private:
+    static std::vector<PatternConfig> modeConfigs(int mode);
     static std::vector<int> buildLPS(const QString &pattern);
-    static std::vector<int> KMPsearch(const QString &text, const QString &pattern);
+    static void KMPsearch(const std::vector<QChar> &lowerText, const CompiledPattern &cp,
+                          std::vector<StyleMapInfo> &styleMap, DensityIndex &density, int category);
 };
 
 #endif // DYSLEXIALOGIC_H
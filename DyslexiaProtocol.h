@@ -0,0 +1,99 @@
+#ifndef DYSLEXIAPROTOCOL_H
+#define DYSLEXIAPROTOCOL_H
+
+#include <QByteArray>
+#include <QtEndian>
+#include <vector>
+#include "DyslexiaLogic.h"
+
+// Protocolo binario entre el servidor local y sus clientes.
+//
+// Cada mensaje es un frame: [u32 tamaño del payload][payload], little-endian.
+//
+// Petición (cliente -> servidor):
+//   u8  tipo (Analyze)
+//   u32 id de petición
+//   i32 modo
+//   i32 longitud del texto (en QChar)
+//   u16 longitud de la clave + clave de la memoria compartida (Latin-1)
+// El texto NO viaja por el socket: está en la memoria compartida como UTF-16.
+//
+// Respuesta (servidor -> cliente):
+//   u8  estado
+//   u32 id de petición
+//   u32 número de tramos
+//   por tramo: i32 inicio, i32 longitud, u32 color (bit 31 = isBackground)
+namespace DyslexiaProtocol {
+
+inline QString defaultServerName() { return QStringLiteral("dyslexia-focus"); }
+
+enum MessageType : quint8 {
+    Analyze = 1
+};
+
+enum Status : quint8 {
+    Ok = 0,
+    BadRequest = 1,
+    BadMode = 2,
+    SharedMemoryError = 3
+};
+
+constexpr quint32 BackgroundFlag = 0x80000000u;
+constexpr int FrameHeaderSize = 4;
+constexpr int RequestFixedSize = 1 + 4 + 4 + 4 + 2;
+constexpr int ResponseFixedSize = 1 + 4 + 4;
+constexpr int SpanSize = 12;
+constexpr quint32 MaxFrameSize = 64u * 1024u * 1024u;
+
+inline void putU16(QByteArray &out, quint16 v) {
+    char b[2]; qToLittleEndian(v, b); out.append(b, 2);
+}
+inline void putU32(QByteArray &out, quint32 v) {
+    char b[4]; qToLittleEndian(v, b); out.append(b, 4);
+}
+inline quint16 getU16(const char *p) { return qFromLittleEndian<quint16>(p); }
+inline quint32 getU32(const char *p) { return qFromLittleEndian<quint32>(p); }
+
+// Reserva el hueco del tamaño; se rellena con endFrame() al terminar el payload
+inline int beginFrame(QByteArray &out) {
+    int at = out.size();
+    putU32(out, 0);
+    return at;
+}
+inline void endFrame(QByteArray &out, int at) {
+    qToLittleEndian<quint32>(quint32(out.size() - at - FrameHeaderSize), out.data() + at);
+}
+
+// Tamaño del siguiente frame completo en el buffer, 0 si aún faltan bytes
+// o -1 si la cabecera es inválida
+inline qsizetype nextFrameSize(const QByteArray &buffer) {
+    if (buffer.size() < FrameHeaderSize) return 0;
+    quint32 size = getU32(buffer.constData());
+    if (size > MaxFrameSize) return -1;
+    if (buffer.size() < FrameHeaderSize + qsizetype(size)) return 0;
+    return FrameHeaderSize + qsizetype(size);
+}
+
+inline void appendSpans(QByteArray &out, const std::vector<TextStyle> &styles) {
+    putU32(out, quint32(styles.size()));
+    for (const TextStyle &s : styles) {
+        putU32(out, quint32(s.start));
+        putU32(out, quint32(s.length));
+        putU32(out, (s.colorHex & ~BackgroundFlag) | (s.isBackground ? BackgroundFlag : 0u));
+    }
+}
+
+// Lee los tramos de p (count ya leído); el llamador garantiza el tamaño
+inline void readSpans(const char *p, quint32 count, std::vector<TextStyle> &out) {
+    out.clear();
+    out.reserve(count);
+    for (quint32 i = 0; i < count; i++, p += SpanSize) {
+        quint32 color = getU32(p + 8);
+        out.push_back({int(getU32(p)), int(getU32(p + 4)),
+                       (color & BackgroundFlag) != 0, color & ~BackgroundFlag});
+    }
+}
+
+} // namespace DyslexiaProtocol
+
+#endif // DYSLEXIAPROTOCOL_H
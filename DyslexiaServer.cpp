@@ -0,0 +1,151 @@
+#include "DyslexiaServer.h"
+#include "DyslexiaProtocol.h"
+
+using namespace DyslexiaProtocol;
+
+// Límite de la caché (en caracteres guardados); al superarlo se vacía entera
+static const qsizetype MaxCachedChars = 16 * 1024 * 1024;
+
+DyslexiaServer::DyslexiaServer(QObject *parent) : QObject(parent) {
+    connect(&server, &QLocalServer::newConnection, this, &DyslexiaServer::onNewConnection);
+
+    // Compilar todos los perfiles al arrancar, no en la primera petición
+    for (int mode = 0; mode < int(cache.size()); mode++) DyslexiaLogic::modeProfile(mode);
+}
+
+bool DyslexiaServer::listen(const QString &serverName) {
+    lastError.clear();
+
+    // Si alguien responde en ese nombre, hay otro servidor vivo: no se toca
+    QLocalSocket probe;
+    probe.connectToServer(serverName);
+    if (probe.waitForConnected(500)) {
+        probe.abort();
+        lastError = QStringLiteral("Ya hay un servidor en ejecución en '%1'").arg(serverName);
+        return false;
+    }
+
+    // Nadie responde: un servidor anterior murió sin cerrar y dejó el socket en disco
+    QLocalServer::removeServer(serverName);
+    server.setSocketOptions(QLocalServer::UserAccessOption);
+    return server.listen(serverName);
+}
+
+QString DyslexiaServer::errorString() const {
+    return lastError.isEmpty() ? server.errorString() : lastError;
+}
+
+void DyslexiaServer::onNewConnection() {
+    while (QLocalSocket *socket = server.nextPendingConnection()) {
+        connections.insert(socket, Connection());
+        connect(socket, &QLocalSocket::readyRead, this, &DyslexiaServer::onReadyRead);
+        connect(socket, &QLocalSocket::disconnected, this, &DyslexiaServer::onDisconnected);
+    }
+}
+
+void DyslexiaServer::onDisconnected() {
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if (!socket) return;
+    connections.remove(socket);
+    socket->deleteLater(); // También libera el segmento compartido adjunto
+}
+
+void DyslexiaServer::onReadyRead() {
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    auto it = connections.find(socket);
+    if (it == connections.end()) return;
+
+    Connection &conn = it.value();
+    conn.buffer.append(socket->readAll());
+
+    // Procesar todos los frames completos que hayan llegado
+    qsizetype consumed = 0;
+    while (true) {
+        QByteArray pending = QByteArray::fromRawData(conn.buffer.constData() + consumed,
+                                                     conn.buffer.size() - consumed);
+        qsizetype frame = nextFrameSize(pending);
+        if (frame < 0) { socket->abort(); return; }
+        if (frame == 0) break;
+        handleRequest(socket, conn, pending.constData() + FrameHeaderSize, frame - FrameHeaderSize);
+        consumed += frame;
+    }
+    conn.buffer.remove(0, consumed);
+}
+
+void DyslexiaServer::handleRequest(QLocalSocket *socket, Connection &conn, const char *payload, qsizetype size) {
+    static const std::vector<TextStyle> noStyles;
+
+    if (size < RequestFixedSize || quint8(payload[0]) != Analyze) {
+        sendReply(socket, BadRequest, 0, noStyles);
+        return;
+    }
+
+    quint32 requestId = getU32(payload + 1);
+    int mode = int(getU32(payload + 5));
+    int textLength = int(getU32(payload + 9));
+    quint16 keyLength = getU16(payload + 13);
+    if (size < RequestFixedSize + keyLength || textLength < 0) {
+        sendReply(socket, BadRequest, requestId, noStyles);
+        return;
+    }
+    if (mode < 0 || mode >= int(cache.size())) {
+        sendReply(socket, BadMode, requestId, noStyles);
+        return;
+    }
+    if (textLength == 0) {
+        sendReply(socket, Ok, requestId, noStyles);
+        return;
+    }
+
+    // Adjuntar el segmento del cliente (solo si cambió desde la última petición)
+    QString key = QString::fromLatin1(payload + RequestFixedSize, keyLength);
+    if (!conn.shm || conn.shm->key() != key) {
+        delete conn.shm;
+        conn.shm = new QSharedMemory(key, socket);
+        if (!conn.shm->attach(QSharedMemory::ReadOnly)) {
+            delete conn.shm;
+            conn.shm = nullptr;
+            sendReply(socket, SharedMemoryError, requestId, noStyles);
+            return;
+        }
+    }
+    if (conn.shm->size() < qsizetype(textLength) * qsizetype(sizeof(QChar))) {
+        sendReply(socket, SharedMemoryError, requestId, noStyles);
+        return;
+    }
+
+    // El texto se lee directamente del segmento, sin copiarlo
+    conn.shm->lock();
+    QString text = QString::fromRawData(static_cast<const QChar *>(conn.shm->constData()), textLength);
+    sendReply(socket, Ok, requestId, analyze(text, mode));
+    conn.shm->unlock();
+}
+
+const std::vector<TextStyle> &DyslexiaServer::analyze(const QString &text, int mode) {
+    QHash<QString, std::vector<TextStyle>> &modeCache = cache[mode];
+
+    auto hit = modeCache.constFind(text);
+    if (hit != modeCache.constEnd()) return hit.value();
+
+    const std::vector<TextStyle> &styles = DyslexiaLogic::analyzeText(text, mode, ctx);
+    if (text.size() > MaxCachedChars) return styles;
+
+    if (cachedChars + text.size() > MaxCachedChars) {
+        for (auto &c : cache) c.clear();
+        cachedChars = 0;
+    }
+    // Copia profunda: 'text' apunta a la memoria compartida del cliente
+    cachedChars += text.size();
+    return modeCache.insert(QString(text.constData(), text.size()), styles).value();
+}
+
+void DyslexiaServer::sendReply(QLocalSocket *socket, quint8 status, quint32 requestId,
+                               const std::vector<TextStyle> &styles) {
+    reply.resize(0); // Conserva la capacidad reservada
+    int at = beginFrame(reply);
+    reply.append(char(status));
+    putU32(reply, requestId);
+    appendSpans(reply, styles);
+    endFrame(reply, at);
+    socket->write(reply);
+}
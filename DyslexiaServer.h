@@ -0,0 +1,54 @@
+#ifndef DYSLEXIASERVER_H
+#define DYSLEXIASERVER_H
+
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSharedMemory>
+#include <QHash>
+#include <array>
+#include <vector>
+#include "DyslexiaLogic.h"
+
+// Servidor local de análisis: mantiene los perfiles compilados y una caché
+// de resultados entre peticiones de procesos distintos (plugins, scripts...)
+class DyslexiaServer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DyslexiaServer(QObject *parent = nullptr);
+
+    // Empieza a escuchar en el socket local indicado (en Unix, un socket de dominio).
+    // Falla si otro servidor ya está escuchando con ese nombre.
+    bool listen(const QString &serverName);
+    QString errorString() const;
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+
+private:
+    struct Connection {
+        QByteArray buffer;            // Bytes recibidos aún sin procesar
+        QSharedMemory *shm = nullptr; // Segmento del cliente (hijo del socket)
+    };
+
+    QLocalServer server;
+    QHash<QLocalSocket *, Connection> connections;
+    QString lastError;
+
+    AnalysisContext ctx;
+    QByteArray reply; // Se reutiliza para cada respuesta
+
+    // Caché de resultados por modo (texto -> tramos)
+    std::array<QHash<QString, std::vector<TextStyle>>, 4> cache;
+    qsizetype cachedChars = 0;
+
+    void handleRequest(QLocalSocket *socket, Connection &conn, const char *payload, qsizetype size);
+    void sendReply(QLocalSocket *socket, quint8 status, quint32 requestId,
+                   const std::vector<TextStyle> &styles);
+    const std::vector<TextStyle> &analyze(const QString &text, int mode);
+};
+
+#endif // DYSLEXIASERVER_H
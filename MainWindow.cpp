@@ -1,5 +1,5 @@
-#include "mainwindow.h"
-#include "dyslexialogic.h"
+#include "MainWindow.h"
+#include "DyslexiaLogic.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFileDialog>
@@ -7,6 +7,9 @@
 #include <QMenu>
 #include <QAction>
 #include <QTextCharFormat>
+#include <QTextLayout>
+#include <QStatusBar>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     // Configuración Ventana
@@ -46,9 +49,17 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     topLayout->addWidget(processBtn);
     layout->addLayout(topLayout);
 
+    hardestBtn = new QPushButton("Ir a lo más difícil");
+    hardestBtn->setStyleSheet("background-color: #E65100; color: white; font-weight: bold; padding: 8px; border-radius: 4px;");
+    topLayout->addWidget(hardestBtn);
+
     // --- ÁREA DE TEXTO (CAMBIO IMPORTANTE) ---
     textEdit = new QTextEdit();
 
+    // Solo texto plano: al pegar no entran colores ni tamaños ajenos, así los
+    // formatos de layout de cada bloque son el único estilo visible
+    textEdit->setAcceptRichText(false);
+
     // Fuente: Verdana o Arial son mejores para dislexia que Times New Roman
     QFont font("Verdana", 18);
     textEdit->setFont(font);
@@ -71,8 +82,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
 
     // Conexiones
     connect(processBtn, &QPushButton::clicked, this, &MainWindow::processText);
+    connect(hardestBtn, &QPushButton::clicked, this, &MainWindow::jumpToHardest);
     connect(openAction, &QAction::triggered, this, &MainWindow::openFile);
     connect(modeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::updateLegend);
+    connect(textEdit->document(), &QTextDocument::contentsChange, this, &MainWindow::onContentsChange);
 
     updateLegend(0);
 }
@@ -119,37 +132,119 @@ void MainWindow::updateLegend(int index) {
     legendLabel->setText(text);
 }
 
+void MainWindow::onContentsChange(int from, int charsRemoved, int charsAdded) {
+    Q_UNUSED(charsRemoved);
+    appliedValid = false;
+    if (appliedStyles.empty()) return;
+
+    // Los bloques editados tienen rangos desfasados: se limpian y la próxima
+    // aplicación recalcula todo el documento
+    QTextDocument *doc = textEdit->document();
+    QTextBlock block = doc->findBlock(from);
+    while (block.isValid() && block.position() <= from + charsAdded) {
+        clearBlockFormats(block);
+        block = block.next();
+    }
+}
+
+void MainWindow::clearBlockFormats(const QTextBlock &block) {
+    QTextLayout *layout = block.layout();
+    if (!layout || layout->formats().isEmpty()) return;
+    layout->clearFormats();
+    textEdit->document()->markContentsDirty(block.position(), block.length());
+}
+
+void MainWindow::applyBlockFormats(const QTextBlock &block, const std::vector<TextStyle> &styles) {
+    QTextLayout *layout = block.layout();
+    if (!layout) return;
+
+    int blockStart = block.position();
+    int blockEnd = blockStart + block.length();
+
+    // Primer estilo que termina dentro o después del bloque (búsqueda binaria)
+    auto it = std::lower_bound(styles.begin(), styles.end(), blockStart,
+                               [](const TextStyle &s, int pos) { return s.start + s.length <= pos; });
+
+    QList<QTextLayout::FormatRange> ranges;
+    for (; it != styles.end() && it->start < blockEnd; ++it) {
+        int start = std::max(it->start, blockStart);
+        int end = std::min(it->start + it->length, blockEnd);
+
+        QTextLayout::FormatRange range;
+        range.start = start - blockStart;
+        range.length = end - start;
+        range.format.setForeground(QColor(it->colorHex));
+        range.format.setFontWeight(QFont::ExtraBold);
+        range.format.setFontPointSize(20);
+        ranges.append(range);
+    }
+
+    if (ranges.isEmpty() && layout->formats().isEmpty()) return;
+
+    // Formatos de layout: no pasan por la pila de deshacer del documento
+    layout->setFormats(ranges);
+    textEdit->document()->markContentsDirty(blockStart, block.length());
+}
+
 void MainWindow::processText() {
     // 1. Obtenemos el texto directamente como QString
     QString qText = textEdit->toPlainText();
 
     if(qText.isEmpty()) return;
 
-    // 2. Limpieza de formato
-    QTextCursor cursor(textEdit->document());
-    cursor.select(QTextCursor::Document);
-    QTextCharFormat fmt;
-    fmt.setForeground(QColor("#333333"));
-    fmt.setBackground(Qt::transparent);
-    fmt.setFontWeight(QFont::Normal);
-    cursor.setCharFormat(fmt);
-
-    // 3. Llamamos a la lógica pasando el QString DIRECTAMENTE
-    // (Ya no usamos stdText)
-    std::vector<TextStyle> styles = DyslexiaLogic::analyzeText(qText, modeCombo->currentIndex());
-
-    // 4. Aplicar estilos
-    for(const auto &style : styles) {
-        cursor.setPosition(style.start);
-        cursor.setPosition(style.start + style.length, QTextCursor::KeepAnchor);
-
-        QTextCharFormat newFmt;
-        QColor color(style.colorHex);
-
-        newFmt.setForeground(color);
-        newFmt.setFontWeight(QFont::ExtraBold);
-        newFmt.setFontPointSize(20);
-
-        cursor.mergeCharFormat(newFmt);
+    // 2. Llamamos a la lógica pasando el QString DIRECTAMENTE
+    const std::vector<TextStyle> &styles = DyslexiaLogic::analyzeText(qText, modeCombo->currentIndex(), analysisCtx);
+
+    QTextDocument *doc = textEdit->document();
+
+    // 3. Aplicar estilos
+    if (!appliedValid) {
+        // Primera vez (o texto editado): se pintan todos los bloques
+        for (QTextBlock block = doc->begin(); block.isValid(); block = block.next())
+            applyBlockFormats(block, styles);
+    } else {
+        // Solo se repintan los bloques cuyo estilo cambió realmente
+        std::vector<TextRange> changes = DyslexiaLogic::diffStyles(appliedStyles, styles);
+        int lastBlock = -1;
+        for (const auto &change : changes) {
+            QTextBlock block = doc->findBlock(change.start);
+            while (block.isValid() && block.position() < change.start + change.length) {
+                if (block.blockNumber() > lastBlock) {
+                    applyBlockFormats(block, styles);
+                    lastBlock = block.blockNumber();
+                }
+                block = block.next();
+            }
+        }
+    }
+
+    appliedStyles = styles; // Copia sobre la capacidad ya reservada
+    appliedValid = true;
+    analyzedMode = modeCombo->currentIndex();
+}
+
+void MainWindow::jumpToHardest() {
+    // El índice debe corresponder al texto actual y al modo elegido
+    if (!appliedValid || analyzedMode != modeCombo->currentIndex()) processText();
+    if (!appliedValid) return;
+
+    // Ventana deslizante sobre el índice de sumas prefijas: O(1) por posición
+    const DensityIndex &density = analysisCtx.density;
+    const int windowChars = 300;
+    TextRange hardest = density.hardestWindow(windowChars);
+    double hardestScore = density.score(hardest.start, hardest.start + hardest.length);
+    if (hardest.length == 0 || hardestScore <= 0.0) {
+        statusBar()->showMessage("No se encontraron zonas difíciles en este modo.", 5000);
+        return;
     }
+
+    QTextCursor cursor(textEdit->document());
+    cursor.setPosition(hardest.start);
+    cursor.setPosition(hardest.start + hardest.length, QTextCursor::KeepAnchor);
+    textEdit->setTextCursor(cursor);
+    textEdit->ensureCursorVisible();
+
+    statusBar()->showMessage(QString("Sección más difícil (párrafo %1): %2 puntos por cada 100 caracteres")
+                                 .arg(textEdit->document()->findBlock(hardest.start).blockNumber() + 1)
+                                 .arg(hardestScore, 0, 'f', 1));
 }
@@ -6,6 +6,9 @@
 #include <QComboBox>
 #include <QPushButton>
 #include <QLabel> // <-- NUEVO: Para la leyenda
+#include <QTextBlock>
+#include <vector>
+#include "DyslexiaLogic.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -17,12 +20,26 @@ private slots:
     void openFile();
     void processText();
     void updateLegend(int index); // <-- NUEVO: Slot para cambiar texto leyenda
+    void onContentsChange(int from, int charsRemoved, int charsAdded);
+    void jumpToHardest();
 
 private:
     QTextEdit *textEdit;
     QComboBox *modeCombo;
     QPushButton *processBtn;
+    QPushButton *hardestBtn;
     QLabel *legendLabel; // <-- NUEVO: El widget de texto
+
+    // Buffers del motor reutilizados en cada análisis
+    AnalysisContext analysisCtx;
+
+    // Estilos actualmente pintados (para aplicar solo la diferencia)
+    std::vector<TextStyle> appliedStyles;
+    bool appliedValid = false;
+    int analyzedMode = -1;
+
+    void applyBlockFormats(const QTextBlock &block, const std::vector<TextStyle> &styles);
+    void clearBlockFormats(const QTextBlock &block);
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
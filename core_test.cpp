@@ -0,0 +1,244 @@
+#include <cstdlib>
+#include <cstdio>
+#include <atomic>
+#include <new>
+#include <vector>
+#include <random>
+#include <string>
+#include "DyslexiaLogic.h"
+
+// Pruebas del motor (solo Qt6::Core, sin GUI ni servidor).
+// Uso: dyslexia-focus-core-test (devuelve 0 si todo pasa)
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    std::printf("%s %s\n", condition ? "[OK]   " : "[FALLO]", what);
+    if (!condition) failures++;
+}
+
+// --- Contador de reservas de memoria ---
+// Con glibc se interceptan malloc/calloc/realloc, así que se cuenta TODA
+// reserva del proceso: std::vector (operator new acaba en malloc) y también
+// QString/QByteArray. En otras plataformas solo se cuenta operator new.
+static std::atomic<long> allocations{0};
+
+#if defined(__GLIBC__)
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *p, size_t size);
+
+void *malloc(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+void *calloc(size_t count, size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+void *realloc(void *p, size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+}
+#else
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+#endif
+
+static void testSteadyStateAllocations() {
+    const QString sample = QStringLiteral(
+        "El bribón dobló la brújula; la pequeña Queca quiso probar el plato.\n"
+        "Guillermo y Josefina llegaron ayer con un gesto de juego.\n"
+        "Un hombre mínimo nunca minimiza una mañana.\n"
+        "La tortilla de Felipe tiene fideos finos y lentejas.");
+    QString big;
+    while (big.size() < 100000) big += sample;
+
+    AnalysisContext ctx;
+    for (int mode = 0; mode < 4; mode++) DyslexiaLogic::analyzeText(big, mode, ctx); // Calentamiento
+
+    size_t growthsBefore = ctx.growths;
+    long allocationsBefore = allocations.load();
+    for (int mode = 0; mode < 4; mode++) {
+        DyslexiaLogic::analyzeText(big, mode, ctx);
+        DyslexiaLogic::analyzeText(sample, mode, ctx);
+    }
+    long steady = allocations.load() - allocationsBefore;
+
+    std::printf("        reservas en estado estable: %ld\n", steady);
+    check(steady == 0, "analyzeText con contexto caliente no reserva memoria");
+    check(ctx.growths == growthsBefore, "growths no cambia en estado estable");
+
+    // Control: el contador funciona (el análisis sin contexto sí reserva)
+    allocationsBefore = allocations.load();
+    DyslexiaLogic::analyzeText(sample, 0);
+    check(allocations.load() > allocationsBefore, "analyzeText sin contexto sí reserva (control)");
+}
+
+// --- diffStyles ---
+
+// Color por carácter (-1 = sin estilo) para comparar contra el barrido
+static std::vector<long long> expand(const std::vector<TextStyle> &styles, int len) {
+    std::vector<long long> colors(len, -1);
+    for (const TextStyle &s : styles)
+        for (int k = s.start; k < s.start + s.length; k++) colors[k] = s.colorHex | (s.isBackground ? 1LL << 32 : 0);
+    return colors;
+}
+
+static bool sameRanges(const std::vector<TextRange> &a, const std::vector<TextRange> &b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i].start != b[i].start || a[i].length != b[i].length) return false;
+    return true;
+}
+
+static std::vector<TextStyle> randomStyles(std::mt19937 &rng, int len) {
+    std::vector<TextStyle> styles;
+    int pos = int(rng() % 3);
+    while (pos < len) {
+        int length = 1 + int(rng() % 4);
+        if (pos + length > len) length = len - pos;
+        styles.push_back({pos, length, rng() % 8 == 0, unsigned(rng() % 3)});
+        pos += length + int(rng() % 3); // Huecos de 0 (adyacentes), 1 o 2
+    }
+    return styles;
+}
+
+static void testDiffStyles() {
+    std::vector<TextStyle> base = {{0, 2, false, 1}, {5, 3, false, 2}, {10, 1, false, 3}};
+
+    check(DyslexiaLogic::diffStyles(base, base).empty(), "diffStyles: mismos estilos -> sin rangos");
+    check(DyslexiaLogic::diffStyles({}, {}).empty(), "diffStyles: listas vacías -> sin rangos");
+    check(sameRanges(DyslexiaLogic::diffStyles(base, {}), {{0, 2}, {5, 3}, {10, 1}}),
+          "diffStyles: quitar todo devuelve cada tramo");
+    check(sameRanges(DyslexiaLogic::diffStyles({{0, 3, false, 1}}, {{5, 2, false, 1}}), {{0, 3}, {5, 2}}),
+          "diffStyles: tramos disjuntos");
+    check(sameRanges(DyslexiaLogic::diffStyles({{0, 6, false, 1}}, {{2, 6, false, 1}}), {{0, 2}, {6, 2}}),
+          "diffStyles: tramos solapados del mismo color");
+    check(sameRanges(DyslexiaLogic::diffStyles({{0, 4, false, 1}}, {{0, 2, false, 2}, {2, 2, false, 3}}), {{0, 4}}),
+          "diffStyles: cambios adyacentes se fusionan");
+    check(DyslexiaLogic::diffStyles({{0, 4, false, 1}}, {{0, 2, false, 1}, {2, 2, false, 1}}).empty(),
+          "diffStyles: partir un tramo sin cambiar el color -> sin rangos");
+    check(sameRanges(DyslexiaLogic::diffStyles({{0, 2, false, 1}}, {{0, 2, true, 1}}), {{0, 2}}),
+          "diffStyles: cambia isBackground");
+
+    // Fuerza bruta carácter a carácter sobre listas aleatorias
+    std::mt19937 rng(26);
+    bool allOk = true;
+    for (int iter = 0; iter < 2000 && allOk; iter++) {
+        int len = int(rng() % 40);
+        std::vector<TextStyle> oldStyles = randomStyles(rng, len);
+        std::vector<TextStyle> newStyles = randomStyles(rng, len);
+        std::vector<long long> before = expand(oldStyles, len), after = expand(newStyles, len);
+
+        std::vector<bool> covered(len, false);
+        int lastEnd = -1;
+        for (const TextRange &r : DyslexiaLogic::diffStyles(oldStyles, newStyles)) {
+            // Ordenados, con longitud positiva y nunca contiguos (ya fusionados)
+            if (r.length <= 0 || r.start <= lastEnd || r.start + r.length > len) allOk = false;
+            lastEnd = r.start + r.length;
+            for (int k = r.start; k < lastEnd && allOk; k++) covered[k] = true;
+        }
+        for (int k = 0; k < len && allOk; k++)
+            if (covered[k] != (before[k] != after[k])) allOk = false;
+    }
+    check(allOk, "diffStyles: coincide con la fuerza bruta en 2000 casos aleatorios");
+}
+
+// --- DensityIndex ---
+
+static void testDensityIndex() {
+    // Índice a mano: letras en 0 y 2 (zona en 0), sílaba en 6, texto de 10
+    DensityIndex idx;
+    idx.reset(10);
+    idx.addMatch(LetterCategory, 0);
+    idx.addMatch(LetterCategory, 2);
+    idx.addMatch(ClusterCategory, 6);
+    idx.addConfusionZones();
+    idx.finish();
+
+    check(idx.length() == 10, "DensityIndex: length");
+    check(idx.count(ConfusionCategory, 0, 1) == 1 && idx.count(ConfusionCategory, 1, 10) == 0,
+          "DensityIndex: la zona de confusión cuenta en su primera letra");
+    check(idx.count(LetterCategory, -5, 100) == 2, "DensityIndex: count recorta el rango al texto");
+    check(idx.count(LetterCategory, 3, 3) == 0 && idx.count(LetterCategory, 5, 2) == 0,
+          "DensityIndex: rango vacío o invertido -> 0");
+    check(idx.count(-1, 0, 10) == 0 && idx.count(CategoryCount, 0, 10) == 0,
+          "DensityIndex: categoría inválida -> 0");
+    check(idx.score(4, 4) == 0.0 && idx.score(12, 20) == 0.0, "DensityIndex: score de rango vacío -> 0");
+    // 2 letras (1) + 1 sílaba (2) + 1 zona (3) = 7 puntos en 10 caracteres
+    check(idx.score(-3, 50) == 70.0 && idx.score(0, 10) == 70.0, "DensityIndex: score pondera y recorta");
+
+    std::vector<double> heat;
+    idx.heatmap(4, heat);
+    check(heat.size() == 3 && heat[0] == 100.0 * 5 / 4 && heat[1] == 100.0 * 2 / 4 && heat[2] == 0.0,
+          "DensityIndex: heatmap por bloques (el último más corto)");
+    TextRange hardest = idx.hardestWindow(3);
+    check(hardest.start == 0 && hardest.length == 3, "DensityIndex: hardestWindow");
+    check(idx.hardestWindow(50).length == 10 && idx.hardestWindow(0).length == 0,
+          "DensityIndex: hardestWindow con ventana mayor que el texto o nula");
+
+    DensityIndex empty;
+    check(empty.length() == 0 && empty.count(LetterCategory, 0, 5) == 0 && empty.score(0, 5) == 0.0,
+          "DensityIndex: índice vacío");
+
+    // Fuerza bruta contra el índice que construye analyzeText
+    std::mt19937 rng(29);
+    const char alphabet[] = "bdpqgjlymnuhitfraeoBDMN  \n";
+    AnalysisContext ctx;
+    bool allOk = true;
+    for (int iter = 0; iter < 300 && allOk; iter++) {
+        std::string raw;
+        int len = int(rng() % 120);
+        for (int i = 0; i < len; i++) raw += alphabet[rng() % (sizeof(alphabet) - 1)];
+        QString text = QString(raw.c_str());
+
+        for (int mode = 0; mode < 4 && allOk; mode++) {
+            DyslexiaLogic::analyzeText(text, mode, ctx);
+
+            std::vector<int> perPos[CategoryCount];
+            for (auto &v : perPos) v.assign(len, 0);
+            for (const auto &cp : DyslexiaLogic::modeProfile(mode)) {
+                int m = cp.pattern.length();
+                for (int i = 0; i + m <= len; i++) {
+                    bool match = true;
+                    for (int k = 0; k < m && match; k++) match = text[i + k].toLower() == cp.pattern[k];
+                    if (match) perPos[m == 1 ? LetterCategory : ClusterCategory][i]++;
+                }
+            }
+            int last = -1;
+            for (int i = 0; i < len; i++) {
+                if (!perPos[LetterCategory][i]) continue;
+                if (last >= 0 && i - last < DensityIndex::ConfusionGap) perPos[ConfusionCategory][last]++;
+                last = i;
+            }
+
+            for (int a = -2; a <= len + 2 && allOk; a += 3) {
+                for (int b = a; b <= len + 4 && allOk; b += 5) {
+                    for (int c = 0; c < CategoryCount; c++) {
+                        int expected = 0;
+                        for (int i = std::max(a, 0); i < std::min(b, len); i++) expected += perPos[c][i];
+                        if (ctx.density.count(c, a, b) != expected) allOk = false;
+                    }
+                }
+            }
+        }
+    }
+    check(allOk, "DensityIndex: coincide con la fuerza bruta en textos aleatorios");
+}
+
+int main() {
+    testSteadyStateAllocations();
+    testDiffStyles();
+    testDensityIndex();
+
+    std::printf("%s\n", failures == 0 ? "Todas las pruebas pasaron" : "Hubo fallos");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+#include <QCoreApplication>
+#include <QTextStream>
+#include "DyslexiaServer.h"
+#include "DyslexiaProtocol.h"
+
+// Servidor local: dyslexia-focus-daemon [nombre-del-socket]
+int main(int argc, char *argv[]) {
+    QCoreApplication a(argc, argv);
+
+    QString serverName = DyslexiaProtocol::defaultServerName();
+    if (a.arguments().size() > 1) serverName = a.arguments().at(1);
+
+    DyslexiaServer server;
+    if (!server.listen(serverName)) {
+        QTextStream(stderr) << "Error: no se pudo escuchar en '" << serverName << "': "
+                            << server.errorString() << "\n";
+        return 1;
+    }
+    QTextStream(stdout) << "Escuchando en '" << serverName << "'\n";
+
+    return a.exec();
+}
@@ -0,0 +1,119 @@
+#include <QCoreApplication>
+#include <QThread>
+#include <QSemaphore>
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <vector>
+#include "DyslexiaServer.h"
+#include "DyslexiaClient.h"
+#include "DyslexiaLogic.h"
+
+// Prueba local del servidor: levanta DyslexiaServer en un hilo con un
+// nombre de socket temporal y lo consulta con DyslexiaClient.
+// Uso: dyslexia-focus-daemon-test (devuelve 0 si todo pasa)
+
+static int failures = 0;
+
+static void check(bool condition, const QString &what) {
+    QTextStream out(stdout);
+    out << (condition ? "[OK]    " : "[FALLO] ") << what << "\n";
+    if (!condition) failures++;
+}
+
+static bool sameStyles(const std::vector<TextStyle> &a, const std::vector<TextStyle> &b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].start != b[i].start || a[i].length != b[i].length ||
+            a[i].isBackground != b[i].isBackground || a[i].colorHex != b[i].colorHex)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication a(argc, argv);
+    QTextStream out(stdout);
+
+    const QString serverName = QStringLiteral("dyslexia-focus-test-%1").arg(QCoreApplication::applicationPid());
+
+    // --- Servidor en su propio hilo (el cliente es bloqueante) ---
+    QSemaphore ready;
+    bool listening = false;
+    QThread *serverThread = QThread::create([&] {
+        DyslexiaServer server;
+        listening = server.listen(serverName);
+        ready.release();
+        if (!listening) return;
+        QEventLoop loop;
+        loop.exec(); // Termina con serverThread->quit()
+    });
+    serverThread->start();
+    ready.acquire();
+    check(listening, "El servidor escucha en " + serverName);
+    if (!listening) return 1;
+
+    // Un segundo servidor con el mismo nombre no debe pisar el socket vivo
+    {
+        DyslexiaServer second;
+        check(!second.listen(serverName), "Un segundo servidor con el mismo nombre es rechazado");
+    }
+
+    DyslexiaClient client;
+    check(client.connectToServer(serverName), "El cliente se conecta");
+
+    const QString sample = QStringLiteral(
+        "El bribón dobló la brújula; la pequeña Queca quiso probar el plato.\n"
+        "Guillermo y Josefina llegaron ayer con un gesto de juego.\n"
+        "Un hombre mínimo nunca minimiza una mañana.\n"
+        "La tortilla de Felipe tiene fideos finos y lentejas.");
+
+    // --- Mismo resultado que el motor local, en cada modo ---
+    std::vector<TextStyle> remote;
+    for (int mode = 0; mode < 4; mode++) {
+        bool ok = client.analyze(sample, mode, remote);
+        check(ok && sameStyles(remote, DyslexiaLogic::analyzeText(sample, mode)),
+              QStringLiteral("Modo %1 coincide con analyzeText").arg(mode));
+    }
+
+    // --- Casos límite ---
+    check(client.analyze(QString(), 0, remote) && remote.empty(), "Texto vacío devuelve cero tramos");
+    check(!client.analyze(sample, 7, remote), "Modo inválido es rechazado");
+    check(client.analyze(sample, 0, remote) && sameStyles(remote, DyslexiaLogic::analyzeText(sample, 0)),
+          "Tras un error la siguiente petición recibe su propia respuesta");
+
+    // Texto mayor que el segmento inicial (64 KB): obliga a crear uno nuevo
+    QString big;
+    while (big.size() < 100000) big += sample;
+    check(client.analyze(big, 2, remote) && sameStyles(remote, DyslexiaLogic::analyzeText(big, 2)),
+          "El segmento compartido crece con textos grandes");
+    check(client.analyze(sample, 3, remote) && sameStyles(remote, DyslexiaLogic::analyzeText(sample, 3)),
+          "Textos pequeños siguen funcionando tras crecer el segmento");
+
+    // --- Latencia de ida y vuelta ---
+    const int rounds = 1000;
+    QElapsedTimer timer;
+    timer.start();
+    bool allOk = true;
+    for (int i = 0; i < rounds; i++) allOk = client.analyze(sample, i % 4, remote) && allOk;
+    qint64 elapsedNs = timer.nsecsElapsed();
+    check(allOk, QStringLiteral("%1 peticiones seguidas").arg(rounds));
+
+    // Arrancar un proceso Qt en frío cuesta decenas de milisegundos; una
+    // petición al servidor caliente debe quedar muy por debajo. El límite es
+    // holgado a propósito (máquinas de CI lentas) pero detecta regresiones
+    // del orden de una reconexión o un análisis completo por petición.
+    const double maxMeanUs = 2000.0;
+    double meanUs = (elapsedNs / rounds) / 1000.0;
+    out << "Latencia media por petición: " << meanUs << " us ("
+        << sample.size() << " caracteres, caché caliente)\n";
+    check(meanUs < maxMeanUs, QStringLiteral("Latencia media por debajo de %1 us").arg(maxMeanUs));
+
+    client.disconnectFromServer();
+    serverThread->quit();
+    serverThread->wait();
+    delete serverThread;
+
+    out << (failures == 0 ? "Todas las pruebas pasaron\n" : "Hubo fallos\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -7,6 +7,7 @@
 #include <fstream>  // Para leer archivos
 #include <sstream>  // Para buffers de string
 #include <filesystem> // Para chequear extensiones (C++17)
+#include "DensityIndex.h" // Índice de dificultad compartido con el motor de la GUI
 
 using namespace std;
 
@@ -171,7 +172,7 @@ vector<Interval> detectConfusionZones(const string &text, const set<char> &trigg
     for(int i=0; i<lowerText.length(); i++) if(triggers.count(lowerText[i])) idxs.push_back(i);
 
     for(size_t i = 0; i + 1 < idxs.size(); i++) {
-        if((idxs[i+1] - idxs[i]) < 5) {
+        if(DensityIndex::isConfusionPair(idxs[i], idxs[i+1])) {
             zones.push_back({idxs[i], idxs[i+1] + 1, "confusion", 100, Color::BOLD, Color::YELLOW_BG});
         }
     }
@@ -212,20 +213,53 @@ void applyIntervalsToCanvas(vector<CharStyle> &canvas, const vector<Interval> &i
 }
 
 // ==========================================
-// 4. MOTOR DE PAGINACIÓN (NUEVO)
+// 4. ÍNDICE DE DIFICULTAD (Sumas prefijas)
 // ==========================================
+// DensityIndex (DensityIndex.h) es el mismo que usa la GUI: mismos pesos,
+// misma distancia de confusión y misma convención de posición. Aquí solo
+// se alimenta con los intervalos del análisis de consola.
 
-void displayPaginated(const string &text, const vector<CharStyle> &canvas) {
+// Se construye en O(N + intervalos) a partir del mismo pase de análisis
+DensityIndex buildDensityIndex(int textLen, const vector<Interval> &intervals) {
+    DensityIndex index;
+    index.reset(textLen);
+
+    for (const auto &inter : intervals) {
+        if (inter.start < 0 || inter.start >= textLen) continue;
+        int category;
+        // La zona empieza en su primera letra: se cuenta ahí (convención del índice)
+        if (inter.type == "confusion") category = ConfusionCategory;
+        else if (inter.type == "pattern") category = (inter.end - inter.start == 1) ? LetterCategory : ClusterCategory;
+        else continue; // Los separadores de sílaba no suman dificultad
+        index.addMatch(category, inter.start);
+    }
+    index.finish();
+    return index;
+}
+
+// ==========================================
+// 5. MOTOR DE PAGINACIÓN (NUEVO)
+// ==========================================
+
+void displayPaginated(const string &text, const vector<CharStyle> &canvas, const DensityIndex &density) {
     int pageSize = 500; // Caracteres por página
     int totalLen = text.length();
     int currentPage = 0;
     int totalPages = (totalLen / pageSize) + 1;
 
+    // Mapa de calor: una puntuación por página (O(1) cada una)
+    vector<double> pageScores;
+    density.heatmap(pageSize, pageScores);
+    pageScores.resize(totalPages, 0.0); // La última página puede estar vacía
+    int hardestPage = max_element(pageScores.begin(), pageScores.end()) - pageScores.begin();
+
     while (true) {
         // Limpiar pantalla (Comando ANSI)
         cout << "\033[2J\033[1;1H"; 
         
-        cout << Color::BOLD << "=== Visor Dyslexia-Focus (Página " << currentPage + 1 << "/" << totalPages << ") ===" << Color::RESET << "\n\n";
+        cout << Color::BOLD << "=== Visor Dyslexia-Focus (Página " << currentPage + 1 << "/" << totalPages << ") ===" << Color::RESET << "\n";
+        cout << Color::GRAY_TXT << "Dificultad: " << (int)pageScores[currentPage] << " pts/100 car."
+             << "  |  Más difícil: página " << hardestPage + 1 << Color::RESET << "\n\n";
 
         int start = currentPage * pageSize;
         int end = min(start + pageSize, totalLen);
@@ -240,7 +274,7 @@ void displayPaginated(const string &text, const vector<CharStyle> &canvas) {
         }
 
         cout << "\n\n" << string(50, '-') << "\n";
-        cout << "[N] Siguiente  |  [P] Anterior  |  [Q] Salir\n";
+        cout << "[N] Siguiente  |  [P] Anterior  |  [D] Página más difícil  |  [Q] Salir\n";
         cout << "Opción: ";
         
         char cmd;
@@ -249,12 +283,13 @@ void displayPaginated(const string &text, const vector<CharStyle> &canvas) {
 
         if (cmd == 'n' && currentPage < totalPages - 1) currentPage++;
         else if (cmd == 'p' && currentPage > 0) currentPage--;
+        else if (cmd == 'd') currentPage = hardestPage;
         else if (cmd == 'q') break;
     }
 }
 
 // ==========================================
-// 5. MAIN
+// 6. MAIN
 // ==========================================
 
 int main() {
@@ -336,9 +371,10 @@ int main() {
     allIntervals.insert(allIntervals.end(), sylls.begin(), sylls.end());
 
     applyIntervalsToCanvas(canvas, allIntervals);
+    DensityIndex density = buildDensityIndex(textToProcess.length(), allIntervals);
 
     // 4. VISUALIZACIÓN PAGINADA
-    displayPaginated(textToProcess, canvas);
+    displayPaginated(textToProcess, canvas, density);
 
     return 0;
 }
\ No newline at end of file